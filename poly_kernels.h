@@ -0,0 +1,632 @@
+// Polynomial kernels for a fixed number of variables.
+//
+// This file is meant to be included once per variable count, with
+// POLY_NVARS defined to a value from 1 to MAX_VARS beforehand. Every type
+// and function below gets the count appended to its name (Term_3,
+// insertTerm_3, ...), so each instantiation stores exactly POLY_NVARS
+// exponents per term and its exponent loops have a constant trip count the
+// compiler can unroll. There is deliberately no include guard.
+
+#ifndef POLY_NVARS
+#error "POLY_NVARS must be defined before including poly_kernels.h"
+#endif
+
+#define POLY_CAT_(name, n) name##_##n
+#define POLY_CAT(name, n) POLY_CAT_(name, n)
+#define POLY_NAME(name) POLY_CAT(name, POLY_NVARS)
+
+#define Term POLY_NAME(Term)
+#define Polynomial POLY_NAME(Polynomial)
+#define TermSink POLY_NAME(TermSink)
+#define MulHeapEntry POLY_NAME(MulHeapEntry)
+#define createPolynomial POLY_NAME(createPolynomial)
+#define destroyPolynomial POLY_NAME(destroyPolynomial)
+#define compareExponents POLY_NAME(compareExponents)
+#define multiplyMonomial POLY_NAME(multiplyMonomial)
+#define dividesMonomial POLY_NAME(dividesMonomial)
+#define insertTerm POLY_NAME(insertTerm)
+#define appendTerm POLY_NAME(appendTerm)
+#define readPolynomial POLY_NAME(readPolynomial)
+#define emitListTerm POLY_NAME(emitListTerm)
+#define emitPrintTerm POLY_NAME(emitPrintTerm)
+#define emitNoTerm POLY_NAME(emitNoTerm)
+#define listSink POLY_NAME(listSink)
+#define beginPrintSink POLY_NAME(beginPrintSink)
+#define finishPrintSink POLY_NAME(finishPrintSink)
+#define emitPolynomial POLY_NAME(emitPolynomial)
+#define printPolynomial POLY_NAME(printPolynomial)
+#define mergePolynomial POLY_NAME(mergePolynomial)
+#define addPolynomial POLY_NAME(addPolynomial)
+#define subtractPolynomial POLY_NAME(subtractPolynomial)
+#define siftDownHeap POLY_NAME(siftDownHeap)
+#define multiplyPolynomialInto POLY_NAME(multiplyPolynomialInto)
+#define multiplyPolynomial POLY_NAME(multiplyPolynomial)
+#define dividePolynomial POLY_NAME(dividePolynomial)
+#define moduloPolynomial POLY_NAME(moduloPolynomial)
+#define copyPolynomial POLY_NAME(copyPolynomial)
+#define getLeadingTerm POLY_NAME(getLeadingTerm)
+#define isZeroPolynomial POLY_NAME(isZeroPolynomial)
+#define multiplyTermByPolynomial POLY_NAME(multiplyTermByPolynomial)
+#define polyLongDivision POLY_NAME(polyLongDivision)
+#define getCachedPower POLY_NAME(getCachedPower)
+#define substitutePolynomial POLY_NAME(substitutePolynomial)
+#define processRecord POLY_NAME(processRecord)
+
+typedef struct Term {
+    int exp[POLY_NVARS];
+    float coeff;
+    struct Term *next;
+} Term;
+
+typedef struct {
+    Term *head;
+} Polynomial;
+
+// Receives finished terms in descending order. Operations that produce
+// their result in order write to a sink, so the caller decides whether the
+// terms are linked into a Polynomial or printed as soon as they are known.
+typedef struct TermSink {
+    void (*emit)(struct TermSink *sink, const int *exp, float coeff);
+    Term **tail;
+    int emitted;
+} TermSink;
+
+typedef struct {
+    int exp[POLY_NVARS];
+    Term *left;
+    Term *right;
+} MulHeapEntry;
+
+Polynomial createPolynomial();
+void destroyPolynomial(Polynomial *p);
+int compareExponents(const int *a, const int *b);
+void multiplyMonomial(int *out, const int *a, const int *b);
+bool dividesMonomial(const int *divisor, const int *dividend);
+void insertTerm(Polynomial *p, const int *exp, float c);
+Term **appendTerm(Term **tail, const int *exp, float c);
+Polynomial readPolynomial();
+void emitListTerm(TermSink *sink, const int *exp, float coeff);
+void emitPrintTerm(TermSink *sink, const int *exp, float coeff);
+void emitNoTerm(TermSink *sink, const int *exp, float coeff);
+TermSink listSink(Polynomial *p);
+TermSink beginPrintSink();
+void finishPrintSink(TermSink *sink);
+void emitPolynomial(Polynomial p, TermSink *sink);
+void printPolynomial(Polynomial p);
+Polynomial mergePolynomial(Polynomial p1, Polynomial p2, float sign);
+Polynomial addPolynomial(Polynomial p1, Polynomial p2);
+Polynomial subtractPolynomial(Polynomial p1, Polynomial p2);
+void siftDownHeap(MulHeapEntry *heap, int size, int i);
+void multiplyPolynomialInto(Polynomial p1, Polynomial p2, TermSink *sink);
+Polynomial multiplyPolynomial(Polynomial p1, Polynomial p2);
+Polynomial dividePolynomial(Polynomial p1, Polynomial p2);
+Polynomial moduloPolynomial(Polynomial p1, Polynomial p2);
+Polynomial copyPolynomial(Polynomial p);
+Term *getLeadingTerm(Polynomial p);
+int isZeroPolynomial(Polynomial p);
+Polynomial multiplyTermByPolynomial(Term *t, Polynomial p);
+Polynomial polyLongDivision(Polynomial A, Polynomial B, TermSink *quotient);
+Polynomial getCachedPower(Polynomial *powers, int k, Polynomial q);
+Polynomial substitutePolynomial(Polynomial p, int var, Polynomial q);
+int processRecord(char op);
+
+Polynomial createPolynomial() {
+    Polynomial p;
+    p.head = NULL;
+    return p;
+}
+
+void destroyPolynomial(Polynomial *p) {
+    Term *current = p->head;
+    Term *next_term;
+    while (current != NULL) {
+        next_term = current->next;
+        free(current);
+        current = next_term;
+    }
+    p->head = NULL;
+}
+
+int compareExponents(const int *a, const int *b) {
+    for (int i = 0; i < POLY_NVARS; ++i) {
+        if (a[i] != b[i])
+            return a[i] - b[i];
+    }
+    return 0;
+}
+
+void multiplyMonomial(int *out, const int *a, const int *b) {
+    for (int i = 0; i < POLY_NVARS; ++i)
+        out[i] = a[i] + b[i];
+}
+
+bool dividesMonomial(const int *divisor, const int *dividend) {
+    for (int i = 0; i < POLY_NVARS; ++i) {
+        if (dividend[i] < divisor[i])
+            return false;
+    }
+    return true;
+}
+
+void insertTerm(Polynomial *p, const int *exp, float c) {
+    if (fabs(c) < EPS) {
+        return;
+    }
+    Term **current_ptr = &(p->head);
+    while (*current_ptr != NULL) {
+        Term *current_node = *current_ptr;
+        int cmp = compareExponents(exp, current_node->exp);
+        if (cmp > 0) {
+            break;
+        } else if (cmp == 0) {
+            current_node->coeff += c;
+            if (fabs(current_node->coeff) < EPS) {
+                *current_ptr = current_node->next;
+                free(current_node);
+            }
+            return;
+        }
+        current_ptr = &(current_node->next);
+    }
+    Term *newNode = (Term *)malloc(sizeof(Term));
+    if (!newNode) {
+        fprintf(stderr, "Error: Memory allocation failed in insertTerm\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(newNode->exp, exp, sizeof(newNode->exp));
+    newNode->coeff = c;
+    newNode->next = *current_ptr;
+    *current_ptr = newNode;
+}
+
+// Links a new term after *tail and returns the new tail slot. Callers
+// building a result in descending order use this instead of insertTerm.
+Term **appendTerm(Term **tail, const int *exp, float c) {
+    Term *newNode = (Term *)malloc(sizeof(Term));
+    if (!newNode) {
+        fprintf(stderr, "Error: Memory allocation failed in appendTerm\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(newNode->exp, exp, sizeof(newNode->exp));
+    newNode->coeff = c;
+    newNode->next = NULL;
+    *tail = newNode;
+    return &(newNode->next);
+}
+
+Polynomial readPolynomial() {
+    int n;
+    Polynomial p = createPolynomial();
+    if (scanf("%d", &n) != 1) {
+        fprintf(stderr, "Error: Failed to read number of terms.\n");
+        destroyPolynomial(&p);
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; ++i) {
+        int exp[POLY_NVARS];
+        float c;
+        for (int v = 0; v < POLY_NVARS; ++v) {
+            if (scanf("%d", &exp[v]) != 1) {
+                fprintf(stderr, "Error: Failed to read term %d.\n", i + 1);
+                destroyPolynomial(&p);
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (scanf("%f", &c) != 1) {
+            fprintf(stderr, "Error: Failed to read term %d.\n", i + 1);
+            destroyPolynomial(&p);
+            exit(EXIT_FAILURE);
+        }
+        insertTerm(&p, exp, c);
+    }
+    return p;
+}
+
+void emitListTerm(TermSink *sink, const int *exp, float coeff) {
+    sink->tail = appendTerm(sink->tail, exp, coeff);
+    sink->emitted++;
+}
+
+void emitPrintTerm(TermSink *sink, const int *exp, float coeff) {
+    if (fabs(coeff) < EPS)
+        return;
+    for (int v = 0; v < POLY_NVARS; ++v)
+        printf("%d ", exp[v]);
+    // Print coefficient with three decimal places
+    printf("%.3f\n", coeff);
+    sink->emitted++;
+}
+
+void emitNoTerm(TermSink *sink, const int *exp, float coeff) {
+    (void)exp;
+    (void)coeff;
+    sink->emitted++;
+}
+
+// p must be empty; emitted terms are appended to it.
+TermSink listSink(Polynomial *p) {
+    TermSink sink = {emitListTerm, &(p->head), 0};
+    return sink;
+}
+
+TermSink beginPrintSink() {
+    TermSink sink = {emitPrintTerm, NULL, 0};
+    printf("---\n");
+    return sink;
+}
+
+void finishPrintSink(TermSink *sink) {
+    if (sink->emitted == 0) {
+        for (int v = 0; v < POLY_NVARS; ++v)
+            printf("0 ");
+        printf("0.000\n");
+    }
+}
+
+void emitPolynomial(Polynomial p, TermSink *sink) {
+    for (Term *current = p.head; current != NULL; current = current->next)
+        sink->emit(sink, current->exp, current->coeff);
+}
+
+void printPolynomial(Polynomial p) {
+    TermSink sink = beginPrintSink();
+    emitPolynomial(p, &sink);
+    finishPrintSink(&sink);
+}
+
+// Merges two descending term lists into p1 + sign * p2, dropping terms
+// that cancel out.
+Polynomial mergePolynomial(Polynomial p1, Polynomial p2, float sign) {
+    Polynomial result = createPolynomial();
+    Term **tail = &(result.head);
+    Term *ptr1 = p1.head;
+    Term *ptr2 = p2.head;
+    while (ptr1 != NULL || ptr2 != NULL) {
+        const int *exp;
+        float newCoeff = 0.0f;
+        int cmp = 0;
+        if (ptr1 != NULL && ptr2 != NULL) {
+            cmp = compareExponents(ptr1->exp, ptr2->exp);
+        } else if (ptr1 != NULL) {
+            cmp = 1;
+        } else {
+            cmp = -1;
+        }
+        if (cmp > 0) {
+            exp = ptr1->exp;
+            newCoeff = ptr1->coeff;
+            ptr1 = ptr1->next;
+        } else if (cmp < 0) {
+            exp = ptr2->exp;
+            newCoeff = sign * ptr2->coeff;
+            ptr2 = ptr2->next;
+        } else {
+            exp = ptr1->exp;
+            newCoeff = ptr1->coeff + sign * ptr2->coeff;
+            ptr1 = ptr1->next;
+            ptr2 = ptr2->next;
+        }
+        if (fabs(newCoeff) >= EPS) {
+            tail = appendTerm(tail, exp, newCoeff);
+        }
+    }
+    return result;
+}
+
+Polynomial addPolynomial(Polynomial p1, Polynomial p2) {
+    return mergePolynomial(p1, p2, 1.0f);
+}
+
+Polynomial subtractPolynomial(Polynomial p1, Polynomial p2) {
+    return mergePolynomial(p1, p2, -1.0f);
+}
+
+void siftDownHeap(MulHeapEntry *heap, int size, int i) {
+    MulHeapEntry entry = heap[i];
+    while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && compareExponents(heap[child + 1].exp, heap[child].exp) > 0)
+            child++;
+        if (compareExponents(heap[child].exp, entry.exp) <= 0)
+            break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = entry;
+}
+
+// Multiplies with a max-heap holding one pending product per term of p1.
+// Products come off the heap in descending order, so each term is final
+// once the next product has a smaller monomial and goes straight to sink.
+void multiplyPolynomialInto(Polynomial p1, Polynomial p2, TermSink *sink) {
+    int size = 0;
+    for (Term *ptr1 = p1.head; ptr1 != NULL; ptr1 = ptr1->next)
+        size++;
+    if (size == 0 || p2.head == NULL)
+        return;
+    MulHeapEntry *heap = (MulHeapEntry *)malloc(size * sizeof(MulHeapEntry));
+    if (!heap) {
+        fprintf(stderr, "Error: Memory allocation failed in multiplyPolynomialInto\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0;
+    for (Term *ptr1 = p1.head; ptr1 != NULL; ptr1 = ptr1->next, ++i) {
+        heap[i].left = ptr1;
+        heap[i].right = p2.head;
+        multiplyMonomial(heap[i].exp, ptr1->exp, p2.head->exp);
+    }
+    for (i = size / 2 - 1; i >= 0; --i)
+        siftDownHeap(heap, size, i);
+
+    while (size > 0) {
+        int exp[POLY_NVARS];
+        float newCoeff = 0.0f;
+        memcpy(exp, heap[0].exp, sizeof(exp));
+        while (size > 0 && compareExponents(heap[0].exp, exp) == 0) {
+            newCoeff += heap[0].left->coeff * heap[0].right->coeff;
+            heap[0].right = heap[0].right->next;
+            if (heap[0].right != NULL) {
+                multiplyMonomial(heap[0].exp, heap[0].left->exp, heap[0].right->exp);
+            } else {
+                heap[0] = heap[--size];
+            }
+            siftDownHeap(heap, size, 0);
+        }
+        if (fabs(newCoeff) >= EPS)
+            sink->emit(sink, exp, newCoeff);
+    }
+    free(heap);
+}
+
+Polynomial multiplyPolynomial(Polynomial p1, Polynomial p2) {
+    Polynomial result = createPolynomial();
+    TermSink sink = listSink(&result);
+    multiplyPolynomialInto(p1, p2, &sink);
+    return result;
+}
+
+Polynomial copyPolynomial(Polynomial p) {
+    Polynomial copy = createPolynomial();
+    Term **tail = &(copy.head);
+    for (Term *current = p.head; current != NULL; current = current->next) {
+        tail = appendTerm(tail, current->exp, current->coeff);
+    }
+    return copy;
+}
+
+Term *getLeadingTerm(Polynomial p) {
+    return p.head;
+}
+
+int isZeroPolynomial(Polynomial p) {
+    return p.head == NULL;
+}
+
+Polynomial multiplyTermByPolynomial(Term *t, Polynomial p) {
+    Polynomial result = createPolynomial();
+    Term **tail = &(result.head);
+    if (fabs(t->coeff) < EPS)
+        return result;
+    for (Term *ptr = p.head; ptr != NULL; ptr = ptr->next) {
+        float newCoeff = t->coeff * ptr->coeff;
+        if (fabs(newCoeff) >= EPS) {
+            int exp[POLY_NVARS];
+            multiplyMonomial(exp, t->exp, ptr->exp);
+            tail = appendTerm(tail, exp, newCoeff);
+        }
+    }
+    return result;
+}
+
+// Divides A by B, sending quotient terms to quotient as they are found and
+// returning the remainder. Each step cancels the leading term of the
+// remainder exactly, so quotient terms come out in strictly descending order.
+Polynomial polyLongDivision(Polynomial A, Polynomial B, TermSink *quotient) {
+    Polynomial remainder = copyPolynomial(A);
+    Term *lt_B = getLeadingTerm(B);
+    if (isZeroPolynomial(B) || lt_B == NULL || fabs(lt_B->coeff) < EPS) {
+        return remainder;
+    }
+    Polynomial B_rest = createPolynomial();
+    B_rest.head = lt_B->next;
+    while (!isZeroPolynomial(remainder)) {
+        Term *lt_R = getLeadingTerm(remainder);
+        if (lt_R == NULL)
+            break;
+        if (dividesMonomial(lt_B->exp, lt_R->exp)) {
+            float T_coeff = lt_R->coeff / lt_B->coeff;
+            if (fabs(T_coeff) < EPS)
+                break;
+            Term T_term_struct;
+            for (int v = 0; v < POLY_NVARS; ++v)
+                T_term_struct.exp[v] = lt_R->exp[v] - lt_B->exp[v];
+            T_term_struct.coeff = T_coeff;
+            T_term_struct.next = NULL;
+            quotient->emit(quotient, T_term_struct.exp, T_coeff);
+            Polynomial T_times_B = multiplyTermByPolynomial(&T_term_struct, B_rest);
+            Polynomial R_rest = createPolynomial();
+            R_rest.head = lt_R->next;
+            Polynomial new_R = subtractPolynomial(R_rest, T_times_B);
+            destroyPolynomial(&remainder);
+            destroyPolynomial(&T_times_B);
+            remainder = new_R;
+        } else {
+            break;
+        }
+    }
+    return remainder;
+}
+
+Polynomial dividePolynomial(Polynomial p1, Polynomial p2) {
+    Polynomial quotient = createPolynomial();
+    TermSink sink = listSink(&quotient);
+    Polynomial remainder = polyLongDivision(p1, p2, &sink);
+    destroyPolynomial(&remainder);
+    return quotient;
+}
+
+Polynomial moduloPolynomial(Polynomial p1, Polynomial p2) {
+    TermSink sink = {emitNoTerm, NULL, 0};
+    return polyLongDivision(p1, p2, &sink);
+}
+
+// Returns q^k, computing it from smaller cached powers on first use.
+// powers[k] stays empty until needed, so only O(log k) entries get filled.
+Polynomial getCachedPower(Polynomial *powers, int k, Polynomial q) {
+    if (!isZeroPolynomial(powers[k]))
+        return powers[k];
+    if (k == 1) {
+        powers[k] = copyPolynomial(q);
+    } else {
+        Polynomial lo = getCachedPower(powers, k / 2, q);
+        Polynomial hi = getCachedPower(powers, k - k / 2, q);
+        powers[k] = multiplyPolynomial(lo, hi);
+    }
+    return powers[k];
+}
+
+// Substitutes q for variable number var (0-based) in p.
+// p is regrouped as sum of c_k * var^k and evaluated in Horner form,
+// jumping over missing exponents with cached powers of q.
+Polynomial substitutePolynomial(Polynomial p, int var, Polynomial q) {
+    int maxExp = -1;
+    for (Term *t = p.head; t != NULL; t = t->next) {
+        if (t->exp[var] > maxExp)
+            maxExp = t->exp[var];
+    }
+    if (maxExp < 0)
+        return createPolynomial();
+
+    Polynomial *coeffs = (Polynomial *)calloc(maxExp + 1, sizeof(Polynomial));
+    Polynomial *powers = (Polynomial *)calloc(maxExp + 1, sizeof(Polynomial));
+    if (!coeffs || !powers) {
+        fprintf(stderr, "Error: Memory allocation failed in substitutePolynomial\n");
+        exit(EXIT_FAILURE);
+    }
+    for (Term *t = p.head; t != NULL; t = t->next) {
+        int exp[POLY_NVARS];
+        memcpy(exp, t->exp, sizeof(exp));
+        exp[var] = 0;
+        insertTerm(&coeffs[t->exp[var]], exp, t->coeff);
+    }
+
+    int k = maxExp;
+    Polynomial acc = copyPolynomial(coeffs[k]);
+    for (int j = k - 1; j >= 0; --j) {
+        if (isZeroPolynomial(coeffs[j]) && j > 0)
+            continue;
+        Polynomial scaled = multiplyPolynomial(acc, getCachedPower(powers, k - j, q));
+        Polynomial sum = addPolynomial(scaled, coeffs[j]);
+        destroyPolynomial(&acc);
+        destroyPolynomial(&scaled);
+        acc = sum;
+        k = j;
+    }
+
+    for (int i = 0; i <= maxExp; ++i) {
+        destroyPolynomial(&coeffs[i]);
+        destroyPolynomial(&powers[i]);
+    }
+    free(coeffs);
+    free(powers);
+    return acc;
+}
+
+// Reads the operands of one record and prints its result. Returns 0 if op
+// is not a known operation. Products and quotients are printed term by
+// term while they are computed instead of being built up first.
+int processRecord(char op) {
+    Polynomial p1 = readPolynomial();
+    int var = (op == '@') ? readVariable(POLY_NVARS) : 0;
+    Polynomial p2 = readPolynomial();
+    Polynomial result;
+    TermSink sink;
+    int processed = 0;
+    int streamed = 0;
+    switch (op) {
+        case '+':
+            result = addPolynomial(p1, p2);
+            processed = 1;
+            break;
+        case '-':
+            result = subtractPolynomial(p1, p2);
+            processed = 1;
+            break;
+        case '*':
+            sink = beginPrintSink();
+            multiplyPolynomialInto(p1, p2, &sink);
+            finishPrintSink(&sink);
+            result = createPolynomial();
+            processed = 1;
+            streamed = 1;
+            break;
+        case '/':
+            sink = beginPrintSink();
+            result = polyLongDivision(p1, p2, &sink);
+            finishPrintSink(&sink);
+            processed = 1;
+            streamed = 1;
+            break;
+        case '%':
+            result = moduloPolynomial(p1, p2);
+            processed = 1;
+            break;
+        case '@':
+            result = substitutePolynomial(p1, var, p2);
+            processed = 1;
+            break;
+        default:
+            processed = 0;
+            break;
+    }
+    if (processed) {
+        if (!streamed)
+            printPolynomial(result);
+        destroyPolynomial(&result);
+    }
+    destroyPolynomial(&p1);
+    destroyPolynomial(&p2);
+    return processed;
+}
+
+#undef Term
+#undef Polynomial
+#undef TermSink
+#undef MulHeapEntry
+#undef createPolynomial
+#undef destroyPolynomial
+#undef compareExponents
+#undef multiplyMonomial
+#undef dividesMonomial
+#undef insertTerm
+#undef appendTerm
+#undef readPolynomial
+#undef emitListTerm
+#undef emitPrintTerm
+#undef emitNoTerm
+#undef listSink
+#undef beginPrintSink
+#undef finishPrintSink
+#undef emitPolynomial
+#undef printPolynomial
+#undef mergePolynomial
+#undef addPolynomial
+#undef subtractPolynomial
+#undef siftDownHeap
+#undef multiplyPolynomialInto
+#undef multiplyPolynomial
+#undef dividePolynomial
+#undef moduloPolynomial
+#undef copyPolynomial
+#undef getLeadingTerm
+#undef isZeroPolynomial
+#undef multiplyTermByPolynomial
+#undef polyLongDivision
+#undef getCachedPower
+#undef substitutePolynomial
+#undef processRecord
+
+#undef POLY_NAME
+#undef POLY_CAT
+#undef POLY_CAT_
+#undef POLY_NVARS